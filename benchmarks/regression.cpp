@@ -0,0 +1,412 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <filesystem>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "../lab_1/matrix.h"
+#include "../lab_2/linked_list.h"
+#include "../lab_3/sorts.h"
+
+// Performance regression suite for the three labs.
+//   regression record   runs every benchmark and stores the samples as this machine's baseline
+//   regression compare  runs every benchmark and compares the samples against the baseline
+// A benchmark is reported as a regression when the Mann-Whitney U test says the
+// two sample sets differ (p < alpha) and the median got slower by more than the threshold.
+
+struct benchmark {
+    std::string name;
+    int iterations;                                // operations timed together in one sample
+    std::function<std::function<void()>()> setup; // builds the inputs, returns the timed operation
+};
+
+volatile long long sink = 0;
+
+std::vector<int> random_ints(int size, unsigned seed) {
+    std::vector<int> arr(size);
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(1, 1000000);
+    for (int& x : arr) x = dis(gen);
+    return arr;
+}
+
+LinkedList<int> random_number(size_t digits, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(0, 9);
+    LinkedList<int> number;
+    for (size_t i = 0; i < digits; i++) number.push_tail(dis(gen));
+    return number;
+}
+
+Matrix<double> random_matrix(size_t rows, size_t cols, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dis(1.0, 100.0);
+    Matrix<double> matrix(rows, cols, 0.0);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) matrix(i, j) = dis(gen);
+    }
+    return matrix;
+}
+
+// Sort a fresh copy of the input every iteration
+template <typename Sort>
+std::function<std::function<void()>()> sort_benchmark(std::function<std::vector<int>()> generate, Sort sort) {
+    return [generate, sort]() -> std::function<void()> {
+        auto input = std::make_shared<std::vector<int>>(generate());
+        auto arr = std::make_shared<std::vector<int>>();
+        return [input, arr, sort]() {
+            *arr = *input;
+            sort(arr->begin(), arr->end());
+            sink += (*arr)[0];
+        };
+    };
+}
+
+using int_iterator = std::vector<int>::iterator;
+
+const std::vector<benchmark> benchmarks = {
+    {"matrix_multiply_64", 20, [] {
+        auto a = std::make_shared<Matrix<double>>(random_matrix(64, 64, 1));
+        auto b = std::make_shared<Matrix<double>>(random_matrix(64, 64, 2));
+        return std::function<void()>([a, b] { sink += static_cast<long long>(((*a) * (*b))(0, 0)); });
+    }},
+    {"matrix_add_256", 20, [] {
+        auto a = std::make_shared<Matrix<double>>(random_matrix(256, 256, 3));
+        auto b = std::make_shared<Matrix<double>>(random_matrix(256, 256, 4));
+        return std::function<void()>([a, b] { sink += static_cast<long long>(((*a) + (*b))(0, 0)); });
+    }},
+    {"matrix_scalar_multiply_256", 20, [] {
+        auto a = std::make_shared<Matrix<double>>(random_matrix(256, 256, 5));
+        return std::function<void()>([a] { sink += static_cast<long long>((2.0 * (*a)).trace()); });
+    }},
+    {"matrix_solve_3x3", 20000, [] {
+        auto a = std::make_shared<Matrix<double>>(random_matrix(3, 3, 6));
+        auto b = std::make_shared<Matrix<double>>(random_matrix(3, 1, 7));
+        return std::function<void()>([a, b] { sink += static_cast<long long>(solve_equation<double>(*a, *b)(0, 0)); });
+    }},
+    {"bignum_sum_10000", 20, [] {
+        auto a = std::make_shared<LinkedList<int>>(random_number(10000, 1));
+        auto b = std::make_shared<LinkedList<int>>(random_number(10000, 2));
+        return std::function<void()>([a, b] { sink += LinkedList<int>::sum(*a, *b).size; });
+    }},
+    {"bignum_multiply_200", 1, [] {
+        auto a = std::make_shared<LinkedList<int>>(random_number(200, 3));
+        auto b = std::make_shared<LinkedList<int>>(random_number(200, 4));
+        return std::function<void()>([a, b] { sink += LinkedList<int>::multiply(*a, *b).size; });
+    }},
+    {"insertion_sort_random_2000", 10, sort_benchmark([] { return random_ints(2000, 1); },
+        [](int_iterator first, int_iterator last) { insertion_sort(first, last); })},
+    {"comb_sort_random_100000", 1, sort_benchmark([] { return random_ints(100000, 1); },
+        [](int_iterator first, int_iterator last) { comb_sort(first, last); })},
+    {"quick_sort_random_100000", 1, sort_benchmark([] { return random_ints(100000, 1); },
+        [](int_iterator first, int_iterator last) { quick_sort(first, last); })},
+    {"tim_sort_random_100000", 1, sort_benchmark([] { return random_ints(100000, 1); },
+        [](int_iterator first, int_iterator last) { tim_sort(first, last); })},
+    {"tim_sort_nearly_sorted_100000", 1, sort_benchmark([] {
+            auto arr = random_ints(100000, 1);
+            std::sort(arr.begin(), arr.end());
+            std::mt19937 gen(1);
+            for (int i = 0; i < 1000; i++) std::swap(arr[gen() % arr.size()], arr[gen() % arr.size()]);
+            return arr;
+        },
+        [](int_iterator first, int_iterator last) { tim_sort(first, last); })},
+};
+
+struct suite_config {
+    std::string mode;
+    std::string baseline_dir = "baselines";
+    std::string machine;
+    std::string filter;
+    int samples = 20;
+    double alpha = 0.01;
+    double threshold = 0.10;
+};
+
+std::string machine_name() {
+#ifdef _WIN32
+    const char* name = std::getenv("COMPUTERNAME");
+    return name ? name : "unknown";
+#else
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) != 0 || name[0] == '\0') return "unknown";
+    return name;
+#endif
+}
+
+std::string baseline_path(const suite_config& config) {
+    return config.baseline_dir + "/" + config.machine + ".csv";
+}
+
+// Nanoseconds per operation of one sample
+double run_sample(const benchmark& bench, const std::function<void()>& operation) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < bench.iterations; i++) operation();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / bench.iterations;
+}
+
+// Samples are taken round-robin over the benchmarks, so that a slow period of
+// the machine is spread over all of them instead of skewing a single one
+std::map<std::string, std::vector<double>> run_suite(const suite_config& config) {
+    std::vector<const benchmark*> selected;
+    std::vector<std::function<void()>> operations;
+    for (const benchmark& bench : benchmarks) {
+        if (bench.name.find(config.filter) == std::string::npos) continue;
+        selected.push_back(&bench);
+        operations.push_back(bench.setup());
+        operations.back()();
+    }
+    if (selected.empty()) throw std::invalid_argument("No benchmark matches --filter " + config.filter);
+
+    std::map<std::string, std::vector<double>> results;
+    for (int s = 0; s < config.samples; s++) {
+        std::cout << "Sample " << s + 1 << "/" << config.samples << std::endl;
+        for (size_t i = 0; i < selected.size(); i++) {
+            results[selected[i]->name].push_back(run_sample(*selected[i], operations[i]));
+        }
+    }
+    return results;
+}
+
+// Baseline file: one `benchmark,ns_per_op` line per sample
+void save_baseline(const std::string& path, const std::map<std::string, std::vector<double>>& results) {
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    std::ofstream file(path);
+    if (!file) throw std::runtime_error("Cannot write baseline: " + path);
+    file << "benchmark,ns_per_op\n" << std::setprecision(10);
+    for (const auto& entry : results) {
+        for (double sample : entry.second) file << entry.first << "," << sample << "\n";
+    }
+}
+
+std::map<std::string, std::vector<double>> load_baseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Cannot read baseline: " + path + " (run `regression record` first)");
+
+    std::map<std::string, std::vector<double>> results;
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        size_t comma = line.find(',');
+        if (comma == std::string::npos) continue;
+        size_t pos = 0;
+        double sample = 0;
+        try {
+            sample = std::stod(line.substr(comma + 1), &pos);
+        } catch (const std::exception&) {
+            pos = 0;
+        }
+        if (pos == 0 || comma + 1 + pos != line.size()) throw std::runtime_error("Invalid baseline line in " + path + ": " + line);
+        results[line.substr(0, comma)].push_back(sample);
+    }
+    return results;
+}
+
+double median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    return n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+}
+
+// Two-sided Mann-Whitney U test, normal approximation with tie correction.
+// Returns the p-value.
+double mann_whitney_p(const std::vector<double>& a, const std::vector<double>& b) {
+    std::vector<std::pair<double, int>> all;
+    for (double x : a) all.push_back({x, 0});
+    for (double x : b) all.push_back({x, 1});
+    std::sort(all.begin(), all.end());
+
+    double n1 = a.size(), n2 = b.size(), n = all.size();
+    double rank_sum_a = 0, tie_term = 0;
+    for (size_t i = 0; i < all.size();) {
+        size_t j = i;
+        while (j < all.size() && all[j].first == all[i].first) j++;
+        double rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (all[k].second == 0) rank_sum_a += rank;
+        }
+        double t = j - i;
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    double u = rank_sum_a - n1 * (n1 + 1) / 2;
+    double mean = n1 * n2 / 2;
+    double variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)));
+    if (variance <= 0) return 1.0;
+
+    double z = (std::abs(u - mean) - 0.5) / std::sqrt(variance);
+    if (z < 0) z = 0;
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+// Smallest p-value the test can give for these sample counts
+double min_p_value(size_t n1, size_t n2) {
+    std::vector<double> a(n1), b(n2);
+    for (size_t i = 0; i < n1; i++) a[i] = i;
+    for (size_t i = 0; i < n2; i++) b[i] = n1 + i;
+    return mann_whitney_p(a, b);
+}
+
+// Returns the number of regressions plus the benchmarks that could not be checked
+int compare(const std::map<std::string, std::vector<double>>& baseline,
+            const std::map<std::string, std::vector<double>>& current, const suite_config& config) {
+    int regressions = 0;
+    std::cout << std::left << std::setw(32) << "benchmark" << std::right
+              << std::setw(16) << "baseline ns" << std::setw(16) << "current ns"
+              << std::setw(10) << "change" << std::setw(10) << "p" << "  verdict\n";
+
+    for (const auto& entry : current) {
+        auto it = baseline.find(entry.first);
+        std::cout << std::left << std::setw(32) << entry.first << std::right;
+        if (it == baseline.end()) {
+            std::cout << std::setw(16) << "-" << std::setw(16) << median(entry.second) << "  NO BASELINE\n";
+            regressions++;
+            continue;
+        }
+
+        double before = median(it->second), after = median(entry.second);
+        double change = (after - before) / before;
+        double p = mann_whitney_p(it->second, entry.second);
+
+        std::string verdict = "ok";
+        if (min_p_value(it->second.size(), entry.second.size()) >= config.alpha) {
+            verdict = "TOO FEW SAMPLES";
+            regressions++;
+        } else if (p < config.alpha && change > config.threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p < config.alpha && change < -config.threshold) {
+            verdict = "improvement";
+        }
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::setw(16) << before << std::setw(16) << after
+                  << std::setprecision(1) << std::setw(9) << change * 100 << "%"
+                  << std::setprecision(4) << std::setw(10) << p
+                  << "  " << verdict << "\n" << std::defaultfloat;
+    }
+    return regressions;
+}
+
+void print_usage() {
+    std::cout << "Usage: regression <record|compare> [options]\n"
+              << "  --baseline-dir dir  where baselines are stored (default baselines)\n"
+              << "  --machine name      baseline name (default: host name)\n"
+              << "  --filter text       only run benchmarks whose name contains text\n"
+              << "  --samples n         samples per benchmark (default 20)\n"
+              << "  --alpha p           significance level of the Mann-Whitney test (default 0.01)\n"
+              << "  --threshold f       smallest median slowdown reported, as a fraction (default 0.10)\n"
+              << "compare exits with status 2 if a regression was found or a benchmark\n"
+              << "has no baseline or too few baseline samples for alpha.\n"
+              << "record with --filter only replaces the selected benchmarks in the baseline.\n";
+}
+
+std::string value_text(double value) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+int parse_positive(const std::string& key, const std::string& value) {
+    size_t pos = 0;
+    int result = 0;
+    try {
+        result = std::stoi(value, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if (pos != value.size() || result <= 0) throw std::invalid_argument("Invalid value for " + key + ": " + value);
+    return result;
+}
+
+double parse_non_negative(const std::string& key, const std::string& value) {
+    size_t pos = 0;
+    double result = 0;
+    try {
+        result = std::stod(value, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if (pos == 0 || pos != value.size() || !(result >= 0)) throw std::invalid_argument("Invalid value for " + key + ": " + value);
+    return result;
+}
+
+suite_config parse_args(const std::vector<std::string>& args) {
+    suite_config config;
+    if (args.empty() || (args[0] != "record" && args[0] != "compare")) {
+        throw std::invalid_argument("Expected `record` or `compare`");
+    }
+    config.mode = args[0];
+
+    for (size_t i = 1; i < args.size(); i += 2) {
+        if (i + 1 == args.size()) throw std::invalid_argument("Missing value for " + args[i]);
+        const std::string& key = args[i];
+        const std::string& value = args[i + 1];
+        if (key == "--baseline-dir") config.baseline_dir = value;
+        else if (key == "--machine") config.machine = value;
+        else if (key == "--filter") config.filter = value;
+        else if (key == "--samples") config.samples = parse_positive(key, value);
+        else if (key == "--alpha") config.alpha = parse_non_negative(key, value);
+        else if (key == "--threshold") config.threshold = parse_non_negative(key, value);
+        else throw std::invalid_argument("Unknown option: " + key);
+    }
+
+    if (config.alpha <= 0 || config.alpha >= 1) throw std::invalid_argument("--alpha must be between 0 and 1");
+    if (config.samples < 2 || min_p_value(config.samples, config.samples) >= config.alpha) {
+        int needed = 2;
+        while (min_p_value(needed, needed) >= config.alpha) needed++;
+        throw std::invalid_argument("--alpha " + value_text(config.alpha) + " needs at least "
+                                    + std::to_string(needed) + " samples");
+    }
+    if (config.machine.empty()) config.machine = machine_name();
+    return config;
+}
+
+int main(int argc, char* argv[]) {
+    suite_config config;
+    try {
+        config = parse_args(std::vector<std::string>(argv + 1, argv + argc));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        print_usage();
+        return 1;
+    }
+
+    try {
+        std::string path = baseline_path(config);
+        if (config.mode == "record") {
+            auto results = run_suite(config);
+            if (!config.filter.empty() && std::filesystem::exists(path)) {
+                auto baseline = load_baseline(path);
+                for (auto& entry : results) baseline[entry.first] = entry.second;
+                results = baseline;
+            }
+            save_baseline(path, results);
+            std::cout << "Baseline written to " << path << std::endl;
+            return 0;
+        }
+
+        auto baseline = load_baseline(path);
+        int regressions = compare(baseline, run_suite(config), config);
+        std::cout << regressions << " failure(s) against " << path << std::endl;
+        return regressions > 0 ? 2 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,420 @@
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <future>
+#include <cstdio>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <filesystem>
+
+// External merge sort for binary files of fixed-size values that do not fit in RAM.
+//   1. The input is streamed in runs of at most `memory` bytes; every run is
+//      sorted in memory and written to a temporary file next to the output.
+//   2. Runs are merged k at a time through a loser tree. Every run and the
+//      output use two buffers: one is consumed/filled by the merge while the
+//      other is read/written by a background task.
+
+using element = std::int32_t;
+
+const size_t max_fan_in = 64;
+const size_t min_buffer_elements = 4096;
+
+struct file_closer {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+file_ptr open_file(const std::string& path, const char* mode) {
+    file_ptr file(std::fopen(path.c_str(), mode));
+    if (!file) throw std::runtime_error("Cannot open file: " + path);
+    return file;
+}
+
+// Double-buffered sequential reader
+template <typename T>
+class run_reader {
+    file_ptr _file;
+    std::vector<T> _front, _back;
+    size_t _pos = 0, _size = 0;
+    std::future<size_t> _pending;
+
+    void prefetch() {
+        std::FILE* file = _file.get();
+        T* dst = _back.data();
+        size_t count = _back.size();
+        _pending = std::async(std::launch::async, [file, dst, count] {
+            return std::fread(dst, sizeof(T), count, file);
+        });
+    }
+
+public:
+    run_reader(const std::string& path, size_t buffer_elements)
+        : _file(open_file(path, "rb")), _front(buffer_elements), _back(buffer_elements) {
+        prefetch();
+        refill();
+    }
+
+    run_reader(const run_reader&) = delete;
+    run_reader& operator=(const run_reader&) = delete;
+
+    ~run_reader() {
+        if (_pending.valid()) _pending.wait();
+    }
+
+    bool empty() const { return _pos == _size; }
+
+    const T& head() const { return _front[_pos]; }
+
+    void advance() {
+        if (++_pos == _size) refill();
+    }
+
+    // Take the buffer filled in the background and start reading the next one
+    void refill() {
+        _pos = 0;
+        _size = 0;
+        if (!_pending.valid()) return;
+
+        _size = _pending.get();
+        std::swap(_front, _back);
+        if (_size == _front.size()) {
+            prefetch();
+        } else if (std::ferror(_file.get())) {
+            throw std::runtime_error("Read error");
+        }
+    }
+};
+
+// Double-buffered sequential writer
+template <typename T>
+class run_writer {
+    file_ptr _file;
+    std::vector<T> _front, _back;
+    size_t _size = 0;
+    size_t _written = 0;
+    std::future<size_t> _pending;
+
+    void wait() {
+        if (!_pending.valid()) return;
+        size_t expected = _written;
+        if (_pending.get() != expected) throw std::runtime_error("Write error");
+    }
+
+public:
+    run_writer(const std::string& path, size_t buffer_elements)
+        : _file(open_file(path, "wb")), _front(buffer_elements), _back(buffer_elements) {}
+
+    run_writer(const run_writer&) = delete;
+    run_writer& operator=(const run_writer&) = delete;
+
+    ~run_writer() {
+        if (_pending.valid()) _pending.wait();
+    }
+
+    void push(const T& value) {
+        _front[_size++] = value;
+        if (_size == _front.size()) flush_async();
+    }
+
+    void write(const T* data, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            push(data[i]);
+        }
+    }
+
+    void flush_async() {
+        wait();
+        std::swap(_front, _back);
+        std::FILE* file = _file.get();
+        const T* src = _back.data();
+        size_t count = _size;
+        _written = count;
+        _size = 0;
+        _pending = std::async(std::launch::async, [file, src, count] {
+            return std::fwrite(src, sizeof(T), count, file);
+        });
+    }
+
+    void close() {
+        flush_async();
+        wait();
+        if (std::fflush(_file.get()) != 0) throw std::runtime_error("Write error");
+        if (std::fclose(_file.release()) != 0) throw std::runtime_error("Write error");
+    }
+};
+
+// Loser tree over k readers. _losers[0] holds the current winner,
+// _losers[1..k-1] the loser of the match played at that node.
+// Exhausted readers lose to everything; ties go to the lower index.
+template <typename T, typename Compare>
+class loser_tree {
+    std::vector<std::unique_ptr<run_reader<T>>>& _runs;
+    std::vector<size_t> _losers;
+    Compare _comp;
+
+    bool beats(size_t a, size_t b) const {
+        if (_runs[a]->empty()) return false;
+        if (_runs[b]->empty()) return true;
+        if (_comp(_runs[a]->head(), _runs[b]->head())) return true;
+        if (_comp(_runs[b]->head(), _runs[a]->head())) return false;
+        return a < b;
+    }
+
+public:
+    loser_tree(std::vector<std::unique_ptr<run_reader<T>>>& runs, Compare comp)
+        : _runs(runs), _losers(runs.size()), _comp(comp) {
+        size_t k = _runs.size();
+        std::vector<size_t> winners(2 * k);
+        for (size_t i = 0; i < k; i++) {
+            winners[k + i] = i;
+        }
+        for (size_t node = k - 1; node > 0; node--) {
+            size_t a = winners[2 * node], b = winners[2 * node + 1];
+            if (beats(a, b)) {
+                winners[node] = a;
+                _losers[node] = b;
+            } else {
+                winners[node] = b;
+                _losers[node] = a;
+            }
+        }
+        _losers[0] = winners[1];
+    }
+
+    bool empty() const { return _runs[_losers[0]]->empty(); }
+
+    const T& top() const { return _runs[_losers[0]]->head(); }
+
+    void pop() {
+        size_t winner = _losers[0];
+        _runs[winner]->advance();
+        for (size_t node = (winner + _runs.size()) / 2; node > 0; node /= 2) {
+            if (beats(_losers[node], winner)) std::swap(_losers[node], winner);
+        }
+        _losers[0] = winner;
+    }
+};
+
+// Temporary run files named after the output plus a random token, so existing
+// files are never overwritten. Files still owned on destruction are removed,
+// so a failed sort does not leave its runs behind.
+class temp_runs {
+    std::string _prefix;
+    size_t _next = 0;
+    std::vector<std::string> _paths;
+
+public:
+    explicit temp_runs(const std::string& output) {
+        std::random_device rd;
+        do {
+            std::ostringstream token;
+            token << std::hex << rd() << rd();
+            _prefix = output + ".run-" + token.str() + "-";
+        } while (std::filesystem::exists(_prefix + "0"));
+    }
+
+    temp_runs(const temp_runs&) = delete;
+    temp_runs& operator=(const temp_runs&) = delete;
+
+    ~temp_runs() {
+        for (const std::string& path : _paths) {
+            std::remove(path.c_str());
+        }
+    }
+
+    std::string create() {
+        _paths.push_back(_prefix + std::to_string(_next++));
+        return _paths.back();
+    }
+
+    // Stop owning the file without deleting it
+    void release(const std::string& path) {
+        _paths.erase(std::find(_paths.begin(), _paths.end(), path));
+    }
+
+    void remove(const std::string& path) {
+        std::remove(path.c_str());
+        release(path);
+    }
+};
+
+double megabytes_per_second(uint64_t bytes, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+// Split the input into sorted runs, returns the paths of the run files
+template <typename T, typename Compare>
+std::vector<std::string> create_runs(const std::string& input, temp_runs& temp,
+                                     size_t memory, Compare comp, uint64_t& bytes) {
+    std::vector<std::string> runs;
+    file_ptr file = open_file(input, "rb");
+    if (std::filesystem::file_size(input) % sizeof(T) != 0) {
+        throw std::runtime_error("Input size is not a multiple of " + std::to_string(sizeof(T)) + " bytes: " + input);
+    }
+    std::vector<T> buffer(std::max(memory / sizeof(T), min_buffer_elements));
+    size_t io_elements = std::max(buffer.size() / 16, min_buffer_elements);
+    bytes = 0;
+
+    while (true) {
+        size_t count = std::fread(buffer.data(), sizeof(T), buffer.size(), file.get());
+        if (std::ferror(file.get())) throw std::runtime_error("Read error: " + input);
+        if (count == 0) break;
+        bytes += count * sizeof(T);
+
+        // quick_sort is quadratic on presorted runs, so runs use introsort
+        std::sort(buffer.begin(), buffer.begin() + count, comp);
+
+        std::string path = temp.create();
+        run_writer<T> writer(path, io_elements);
+        writer.write(buffer.data(), count);
+        writer.close();
+        runs.push_back(path);
+
+        if (count < buffer.size()) break;
+    }
+    return runs;
+}
+
+template <typename T, typename Compare>
+void merge_runs(const std::vector<std::string>& inputs, const std::string& output,
+                size_t memory, Compare comp) {
+    size_t buffer_elements = std::max(memory / sizeof(T) / (2 * (inputs.size() + 1)), min_buffer_elements);
+
+    std::vector<std::unique_ptr<run_reader<T>>> readers;
+    for (const std::string& path : inputs) {
+        readers.push_back(std::make_unique<run_reader<T>>(path, buffer_elements));
+    }
+    run_writer<T> writer(output, buffer_elements);
+
+    loser_tree<T, Compare> tree(readers, comp);
+    while (!tree.empty()) {
+        writer.push(tree.top());
+        tree.pop();
+    }
+    writer.close();
+}
+
+template <typename T, typename Compare = std::less<>>
+void external_sort(const std::string& input, const std::string& output, size_t memory,
+                   Compare comp = Compare()) {
+    using clock = std::chrono::steady_clock;
+    temp_runs temp(output);
+    uint64_t bytes = 0;
+
+    auto start = clock::now();
+    std::vector<std::string> runs = create_runs<T>(input, temp, memory, comp, bytes);
+    auto runs_done = clock::now();
+    std::cout << "Created " << runs.size() << " runs, "
+              << megabytes_per_second(bytes, runs_done - start) << " MB/s" << std::endl;
+
+    if (runs.empty()) {
+        open_file(output, "wb");
+    } else if (runs.size() == 1) {
+        if (std::rename(runs[0].c_str(), output.c_str()) != 0) {
+            throw std::runtime_error("Cannot rename " + runs[0] + " to " + output);
+        }
+        temp.release(runs[0]);
+    }
+
+    // Intermediate merges combine only as many runs as needed to bring the
+    // count down to max_fan_in, then a single final merge writes the output
+    while (runs.size() > max_fan_in) {
+        size_t count = std::min(max_fan_in, runs.size() - max_fan_in + 1);
+        std::vector<std::string> group(runs.begin(), runs.begin() + count);
+        runs.erase(runs.begin(), runs.begin() + count);
+
+        uint64_t group_bytes = 0;
+        for (const std::string& run : group) {
+            group_bytes += std::filesystem::file_size(run);
+        }
+
+        auto merge_start = clock::now();
+        std::string path = temp.create();
+        merge_runs<T>(group, path, memory, comp);
+        for (const std::string& run : group) {
+            temp.remove(run);
+        }
+        runs.push_back(path);
+        std::cout << "Merged " << count << " runs, "
+                  << megabytes_per_second(group_bytes, clock::now() - merge_start) << " MB/s" << std::endl;
+    }
+
+    if (runs.size() > 1) {
+        auto merge_start = clock::now();
+        merge_runs<T>(runs, output, memory, comp);
+        for (const std::string& run : runs) {
+            temp.remove(run);
+        }
+        std::cout << "Final merge of " << runs.size() << " runs, "
+                  << megabytes_per_second(bytes, clock::now() - merge_start) << " MB/s" << std::endl;
+    }
+
+    std::cout << "Sorted " << bytes / (1024.0 * 1024.0) << " MB, "
+              << megabytes_per_second(bytes, clock::now() - start) << " MB/s" << std::endl;
+}
+
+// Generate a file of random values
+void generate_file(const std::string& path, uint64_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<element> dis;
+    run_writer<element> writer(path, 1 << 16);
+    for (uint64_t i = 0; i < count; i++) {
+        writer.push(dis(gen));
+    }
+    writer.close();
+}
+
+// Check that a file is sorted
+bool check_file(const std::string& path) {
+    run_reader<element> reader(path, 1 << 16);
+    if (reader.empty()) return true;
+    element prev = reader.head();
+    for (reader.advance(); !reader.empty(); reader.advance()) {
+        if (reader.head() < prev) return false;
+        prev = reader.head();
+    }
+    return true;
+}
+
+void print_usage() {
+    std::cout << "Usage:\n"
+              << "  external_sort sort <input> <output> [memory_mb]\n"
+              << "  external_sort generate <output> <count> [seed]\n"
+              << "  external_sort check <input>\n"
+              << "Files contain raw 32-bit integers.\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    try {
+        if (args.size() >= 3 && args[0] == "sort") {
+            size_t memory_mb = args.size() > 3 ? std::stoul(args[3]) : 256;
+            external_sort<element>(args[1], args[2], memory_mb * 1024 * 1024);
+        } else if (args.size() >= 3 && args[0] == "generate") {
+            unsigned seed = args.size() > 3 ? std::stoul(args[3]) : 0;
+            generate_file(args[1], std::stoull(args[2]), seed);
+        } else if (args.size() == 2 && args[0] == "check") {
+            bool sorted = check_file(args[1]);
+            std::cout << (sorted ? "sorted" : "not sorted") << std::endl;
+            return sorted ? 0 : 1;
+        } else {
+            print_usage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -5,102 +5,16 @@
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cmath>
 
-struct stats {
-    size_t comparison_count = 0;
-    size_t copy_count = 0;
-
-    stats& operator += (const stats& other) {
-        comparison_count += other.comparison_count;
-        copy_count += other.copy_count;
-        return *this;
-    }
-};
-
-// Insertion Sort
-stats insertion_sort(std::vector<int>& arr) {
-    stats statistics;
-    int n = arr.size();
-    
-    for (int i = 1; i < n; i++) {
-        int key = arr[i];
-        statistics.copy_count++;
-        int j = i - 1;
-        
-        while (j >= 0) {
-            statistics.comparison_count++;
-            if (arr[j] > key) {
-                arr[j + 1] = arr[j];
-                statistics.copy_count++;
-                j--;
-            } else {
-                break;
-            }
-        }
-        arr[j + 1] = key;
-        statistics.copy_count++;
-    }
-    
-    return statistics;
-}
-
-// Comb Sort
-stats comb_sort(std::vector<int>& arr) {
-    stats statistics;
-    int n = arr.size();
-    int gap = n;
-    bool swapped = true;
-    const double shrink_factor = 1.3;
-    
-    while (gap > 1 || swapped) {
-        gap = static_cast<int>(gap / shrink_factor);
-        if (gap < 1) gap = 1;
-        
-        swapped = false;
-        for (int i = 0; i + gap < n; i++) {
-            statistics.comparison_count++;
-            if (arr[i] > arr[i + gap]) {
-                std::swap(arr[i], arr[i + gap]);
-                statistics.copy_count += 3;
-                swapped = true;
-            }
-        }
-    }
-    
-    return statistics;
-}
-
-// Quick Sort helper function
-stats quick_sort_helper(std::vector<int>& arr, int low, int high, stats& statistics) {
-    if (low < high) {
-        int pivot = arr[high];
-        statistics.copy_count++;
-        int i = low - 1;
-        
-        for (int j = low; j < high; j++) {
-            statistics.comparison_count++;
-            if (arr[j] <= pivot) {
-                i++;
-                std::swap(arr[i], arr[j]);
-                statistics.copy_count += 3;
-            }
-        }
-        
-        std::swap(arr[i + 1], arr[high]);
-        statistics.copy_count += 3;
-        
-        int partition = i + 1;
-        quick_sort_helper(arr, low, partition - 1, statistics);
-        quick_sort_helper(arr, partition + 1, high, statistics);
-    }
-    return statistics;
-}
-
-// Quick Sort
-stats quick_sort(std::vector<int>& arr) {
-    stats statistics;
-    return quick_sort_helper(arr, 0, arr.size() - 1, statistics);
-}
+#include "sorts.h"
 
 // Generate random array
 std::vector<int> generate_random_array(int size, unsigned seed) {
@@ -132,84 +46,396 @@ std::vector<int> generate_reverse_sorted_array(int size) {
     return arr;
 }
 
-// Function to run analysis for a specific size
-void analyze_for_size(int size, std::ofstream& outFile) {
-    // Average case (100 random arrays)
-    stats avg_insertion = {0, 0}, avg_comb = {0, 0}, avg_quick = {0, 0};
-    
-    for (int i = 0; i < 100; i++) {
-        auto arr1 = generate_random_array(size, i);
-        auto arr2 = arr1;
-        auto arr3 = arr1;
-        
-        avg_insertion += insertion_sort(arr1);
-        avg_comb += comb_sort(arr2);
-        avg_quick += quick_sort(arr3);
+// Generate nearly sorted array (sorted, then 1% of the elements swapped in random pairs)
+std::vector<int> generate_nearly_sorted_array(int size, unsigned seed) {
+    std::vector<int> arr = generate_sorted_array(size);
+    if (size < 2) return arr;
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(0, size - 1);
+    int swaps = std::max(1, size / 100);
+    for (int i = 0; i < swaps; i++) {
+        std::swap(arr[dis(gen)], arr[dis(gen)]);
     }
-    
-    avg_insertion.comparison_count /= 100;
-    avg_insertion.copy_count /= 100;
-    avg_comb.comparison_count /= 100;
-    avg_comb.copy_count /= 100;
-    avg_quick.comparison_count /= 100;
-    avg_quick.copy_count /= 100;
-    
-    // Best case (sorted array)
-    auto sorted_arr1 = generate_sorted_array(size);
-    auto sorted_arr2 = sorted_arr1;
-    auto sorted_arr3 = sorted_arr1;
-    
-    auto best_insertion = insertion_sort(sorted_arr1);
-    auto best_comb = comb_sort(sorted_arr2);
-    auto best_quick = quick_sort(sorted_arr3);
-    
-    // Worst case (reverse sorted array)
-    auto reverse_arr1 = generate_reverse_sorted_array(size);
-    auto reverse_arr2 = reverse_arr1;
-    auto reverse_arr3 = reverse_arr1;
-    
-    auto worst_insertion = insertion_sort(reverse_arr1);
-    auto worst_comb = comb_sort(reverse_arr2);
-    auto worst_quick = quick_sort(reverse_arr3);
-    
-    // Write results to file
-    outFile << size << ","
-            << avg_insertion.comparison_count << "," << avg_insertion.copy_count << ","
-            << best_insertion.comparison_count << "," << best_insertion.copy_count << ","
-            << worst_insertion.comparison_count << "," << worst_insertion.copy_count << ","
-            << avg_comb.comparison_count << "," << avg_comb.copy_count << ","
-            << best_comb.comparison_count << "," << best_comb.copy_count << ","
-            << worst_comb.comparison_count << "," << worst_comb.copy_count << ","
-            << avg_quick.comparison_count << "," << avg_quick.copy_count << ","
-            << best_quick.comparison_count << "," << best_quick.copy_count << ","
-            << worst_quick.comparison_count << "," << worst_quick.copy_count << "\n";
-}
-
-int main() {
-    std::ofstream outFile("sorting_analysis.csv");
-    
-    // Write CSV header
-    outFile << "Size,"
-            << "Insertion_Avg_Comp,Insertion_Avg_Copy,"
-            << "Insertion_Best_Comp,Insertion_Best_Copy,"
-            << "Insertion_Worst_Comp,Insertion_Worst_Copy,"
-            << "Comb_Avg_Comp,Comb_Avg_Copy,"
-            << "Comb_Best_Comp,Comb_Best_Copy,"
-            << "Comb_Worst_Comp,Comb_Worst_Copy,"
-            << "Quick_Avg_Comp,Quick_Avg_Copy,"
-            << "Quick_Best_Comp,Quick_Best_Copy,"
-            << "Quick_Worst_Comp,Quick_Worst_Copy\n";
-    
-    // Analyze for different sizes
-    std::vector<int> sizes = {1000, 2000, 3000, 4000, 5000}; //, 6000, 7000, 8000, 9000, 10000, 25000, 50000, 100000
-    
-    for (int size : sizes) {
-        std::cout << "Analyzing for size: " << size << std::endl;
-        analyze_for_size(size, outFile);
+    return arr;
+}
+
+// Generate array with few unique values
+std::vector<int> generate_few_unique_array(int size, unsigned seed) {
+    std::vector<int> arr(size);
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(1, 10);
+
+    for (int i = 0; i < size; i++) {
+        arr[i] = dis(gen);
     }
-    
-    outFile.close();
-    std::cout << "Analysis complete. Results written to sorting_analysis.csv" << std::endl;
-    
+    return arr;
+}
+
+// Generate organ pipe array (ascending first half, descending second half)
+std::vector<int> generate_organ_pipe_array(int size) {
+    std::vector<int> arr(size);
+    for (int i = 0; i < size; i++) {
+        arr[i] = i < size / 2 ? i : size - i;
+    }
+    return arr;
+}
+
+// Generate sawtooth array (10 ascending ramps)
+std::vector<int> generate_sawtooth_array(int size) {
+    std::vector<int> arr(size);
+    int period = std::max(1, size / 10);
+    for (int i = 0; i < size; i++) {
+        arr[i] = i % period;
+    }
+    return arr;
+}
+
+// `count` runs the instrumented sort, `sort` the uninstrumented one used for timing
+struct sort_algorithm {
+    std::string name;
+    stats (*count)(std::vector<int>&);
+    void (*sort)(std::vector<int>&);
+    std::vector<std::string> quadratic_on; // distributions on which the sort is O(n^2)
+};
+
+// Input pattern; seeded generators produce a different array for every repetition,
+// fixed ones the same array every time
+struct input_case {
+    std::string name;
+    std::function<std::vector<int>(int size, unsigned seed)> generate;
+    bool seeded;
+};
+
+const std::vector<sort_algorithm> algorithms = {
+    {"Insertion", insertion_sort, [](std::vector<int>& arr) { insertion_sort(arr.begin(), arr.end()); },
+        {"Avg", "Worst", "NearlySorted", "FewUnique", "OrganPipe", "Sawtooth"}},
+    {"Comb", comb_sort, [](std::vector<int>& arr) { comb_sort(arr.begin(), arr.end()); }, {}},
+    // Avg only has 10000 distinct values, so large arrays are mostly duplicates
+    {"Quick", quick_sort, [](std::vector<int>& arr) { quick_sort(arr.begin(), arr.end()); },
+        {"Avg", "Best", "Worst", "NearlySorted", "FewUnique", "OrganPipe", "Sawtooth"}},
+    {"Tim", tim_sort, [](std::vector<int>& arr) { tim_sort(arr.begin(), arr.end()); }, {}},
+};
+
+const std::vector<input_case> input_cases = {
+    {"Avg", generate_random_array, true},
+    {"Best", [](int size, unsigned) { return generate_sorted_array(size); }, false},
+    {"Worst", [](int size, unsigned) { return generate_reverse_sorted_array(size); }, false},
+    {"NearlySorted", generate_nearly_sorted_array, true},
+    {"FewUnique", generate_few_unique_array, true},
+    {"OrganPipe", [](int size, unsigned) { return generate_organ_pipe_array(size); }, false},
+    {"Sawtooth", [](int size, unsigned) { return generate_sawtooth_array(size); }, false},
+};
+
+struct benchmark_config {
+    std::vector<std::string> algorithms;
+    std::vector<std::string> distributions;
+    std::vector<int> sizes = {1000, 2000, 3000, 4000, 5000};
+    int repetitions = 100;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    int quadratic_cap = 20000;
+    std::string long_csv = "benchmark_results.csv";
+    std::string json = "benchmark_results.json";
+
+    benchmark_config() {
+        for (const sort_algorithm& algorithm : ::algorithms) algorithms.push_back(algorithm.name);
+        for (const input_case& input : input_cases) distributions.push_back(input.name);
+    }
+};
+
+std::vector<std::string> split_list(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+int parse_positive(const std::string& key, const std::string& value) {
+    size_t pos = 0;
+    int result = 0;
+    try {
+        result = std::stoi(value, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if (pos != value.size() || result <= 0) throw std::invalid_argument("Invalid value for " + key + ": " + value);
+    return result;
+}
+
+void set_option(benchmark_config& config, const std::string& key, const std::string& value) {
+    if (key == "algorithms") {
+        config.algorithms = split_list(value);
+        for (const std::string& name : config.algorithms) {
+            auto it = std::find_if(algorithms.begin(), algorithms.end(), [&](const sort_algorithm& a) { return a.name == name; });
+            if (it == algorithms.end()) throw std::invalid_argument("Unknown algorithm: " + name);
+        }
+    } else if (key == "distributions") {
+        config.distributions = split_list(value);
+        for (const std::string& name : config.distributions) {
+            auto it = std::find_if(input_cases.begin(), input_cases.end(), [&](const input_case& c) { return c.name == name; });
+            if (it == input_cases.end()) throw std::invalid_argument("Unknown distribution: " + name);
+        }
+    } else if (key == "sizes") {
+        config.sizes.clear();
+        for (const std::string& size : split_list(value)) {
+            config.sizes.push_back(parse_positive(key, size));
+        }
+    } else if (key == "repetitions") {
+        config.repetitions = parse_positive(key, value);
+    } else if (key == "threads") {
+        config.threads = parse_positive(key, value);
+    } else if (key == "quadratic-cap") {
+        config.quadratic_cap = parse_positive(key, value);
+    } else if (key == "csv") {
+        config.long_csv = value;
+    } else if (key == "json") {
+        config.json = value;
+    } else {
+        throw std::invalid_argument("Unknown option: " + key);
+    }
+}
+
+// Config file: one `key = value` per line, `#` starts a comment
+void load_config(benchmark_config& config, const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::invalid_argument("Cannot open config file: " + path);
+
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        size_t eq = line.find('=');
+        auto trim = [](std::string s) {
+            s.erase(0, s.find_first_not_of(" \t\r"));
+            s.erase(s.find_last_not_of(" \t\r") + 1);
+            return s;
+        };
+        if (trim(line).empty()) continue;
+        if (eq == std::string::npos) throw std::invalid_argument("Invalid config line: " + line);
+        set_option(config, trim(line.substr(0, eq)), trim(line.substr(eq + 1)));
+    }
+}
+
+void print_usage() {
+    std::cout << "Usage: lab3 [--config file] [--key value ...]\n"
+              << "Options (also accepted as `key = value` lines in the config file):\n"
+              << "  --algorithms     comma-separated list (Insertion,Comb,Quick,Tim)\n"
+              << "  --distributions  comma-separated list (Avg,Best,Worst,NearlySorted,FewUnique,OrganPipe,Sawtooth)\n"
+              << "  --sizes          comma-separated array sizes\n"
+              << "  --repetitions    timed sorts per cell; seeded inputs are also counted this many times (default 100)\n"
+              << "  --threads        worker threads for counting; timing is single-threaded (default: hardware concurrency)\n"
+              << "  --quadratic-cap  largest size run for algorithm/distribution pairs that are O(n^2) (default 20000)\n"
+              << "  --csv            long-format results read by plot.py (default benchmark_results.csv)\n"
+              << "  --json           long-format results as JSON (default benchmark_results.json)\n"
+              << "An empty output path disables that output.\n";
+}
+
+benchmark_config parse_args(const std::vector<std::string>& args) {
+    benchmark_config config;
+
+    // The config file is applied first so that command line options override it
+    for (size_t i = 0; i + 1 < args.size(); i++) {
+        if (args[i] == "--config") load_config(config, args[i + 1]);
+    }
+
+    for (size_t i = 0; i < args.size(); i++) {
+        if (args[i].compare(0, 2, "--") != 0 || i + 1 == args.size()) {
+            throw std::invalid_argument("Invalid argument: " + args[i]);
+        }
+        if (args[i] != "--config") set_option(config, args[i].substr(2), args[i + 1]);
+        i++;
+    }
+    return config;
+}
+
+struct summary {
+    double mean = 0, median = 0, stddev = 0, ci_low = 0, ci_high = 0;
+};
+
+// Mean, median and 95% confidence interval of the mean (normal approximation)
+summary summarize(std::vector<double> samples) {
+    summary result;
+    size_t n = samples.size();
+    if (n == 0) return result;
+
+    for (double x : samples) result.mean += x;
+    result.mean /= n;
+
+    std::sort(samples.begin(), samples.end());
+    result.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+
+    if (n > 1) {
+        double sum_sq = 0;
+        for (double x : samples) sum_sq += (x - result.mean) * (x - result.mean);
+        result.stddev = std::sqrt(sum_sq / (n - 1));
+    }
+    double half_width = 1.96 * result.stddev / std::sqrt(static_cast<double>(n));
+    result.ci_low = result.mean - half_width;
+    result.ci_high = result.mean + half_width;
+    return result;
+}
+
+// One (algorithm, distribution, size) combination
+struct benchmark_cell {
+    const sort_algorithm* algorithm;
+    const input_case* input;
+    int size;
+    std::vector<double> comparisons, copies, time_us;
+};
+
+// Counts are deterministic, so a fixed input is counted only once
+void count_cell(benchmark_cell& cell, int repetitions) {
+    int count_repetitions = cell.input->seeded ? repetitions : 1;
+    for (int i = 0; i < count_repetitions; i++) {
+        auto arr = cell.input->generate(cell.size, i);
+        stats statistics = cell.algorithm->count(arr);
+        cell.comparisons.push_back(statistics.comparison_count);
+        cell.copies.push_back(statistics.copy_count);
+    }
+}
+
+void time_cell(benchmark_cell& cell, int repetitions) {
+    for (int i = 0; i < repetitions; i++) {
+        auto arr = cell.input->generate(cell.size, i);
+        auto start = std::chrono::steady_clock::now();
+        cell.algorithm->sort(arr);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        cell.time_us.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+}
+
+// Counting is deterministic, so cells are counted on the worker threads, one
+// cell at a time, largest first. Timings would be skewed by the other workers
+// competing for the cores, so they are taken afterwards on a single thread.
+void run_cells(std::vector<benchmark_cell>& cells, const benchmark_config& config) {
+    std::vector<size_t> order(cells.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return cells[a].size > cells[b].size; });
+
+    std::atomic<size_t> next(0);
+    std::mutex output_mutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < order.size(); i = next++) {
+            benchmark_cell& cell = cells[order[i]];
+            count_cell(cell, config.repetitions);
+
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << "Counted " << cell.algorithm->name << " / " << cell.input->name
+                      << " / " << cell.size << std::endl;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < config.threads; i++) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+
+    for (benchmark_cell& cell : cells) {
+        time_cell(cell, config.repetitions);
+        std::cout << "Timed " << cell.algorithm->name << " / " << cell.input->name
+                  << " / " << cell.size << std::endl;
+    }
+}
+
+std::vector<benchmark_cell> make_cells(const benchmark_config& config, size_t& skipped) {
+    std::vector<benchmark_cell> cells;
+    skipped = 0;
+    for (const std::string& algorithm_name : config.algorithms) {
+        const sort_algorithm& algorithm = *std::find_if(algorithms.begin(), algorithms.end(),
+            [&](const sort_algorithm& a) { return a.name == algorithm_name; });
+        for (const std::string& input_name : config.distributions) {
+            const input_case& input = *std::find_if(input_cases.begin(), input_cases.end(),
+                [&](const input_case& c) { return c.name == input_name; });
+            bool quadratic = std::find(algorithm.quadratic_on.begin(), algorithm.quadratic_on.end(), input.name)
+                             != algorithm.quadratic_on.end();
+            for (int size : config.sizes) {
+                if (quadratic && size > config.quadratic_cap) {
+                    skipped++;
+                    continue;
+                }
+                cells.push_back({&algorithm, &input, size, {}, {}, {}});
+            }
+        }
+    }
+    return cells;
+}
+
+const std::vector<std::pair<std::string, std::vector<double> benchmark_cell::*>> metrics = {
+    {"comparisons", &benchmark_cell::comparisons},
+    {"copies", &benchmark_cell::copies},
+    {"time_us", &benchmark_cell::time_us},
+};
+
+// One row per cell and metric
+void write_long_csv(const std::vector<benchmark_cell>& cells, const benchmark_config& config) {
+    std::ofstream outFile(config.long_csv);
+    outFile << "algorithm,distribution,size,metric,repetitions,mean,median,stddev,ci95_low,ci95_high\n";
+    outFile << std::setprecision(10);
+
+    for (const benchmark_cell& cell : cells) {
+        for (const auto& metric : metrics) {
+            summary s = summarize(cell.*metric.second);
+            outFile << cell.algorithm->name << "," << cell.input->name << "," << cell.size << ","
+                    << metric.first << "," << (cell.*metric.second).size() << ","
+                    << s.mean << "," << s.median << "," << s.stddev << ","
+                    << s.ci_low << "," << s.ci_high << "\n";
+        }
+    }
+}
+
+void write_json(const std::vector<benchmark_cell>& cells, const benchmark_config& config) {
+    std::ofstream outFile(config.json);
+    outFile << "[\n" << std::setprecision(10);
+
+    bool first = true;
+    for (const benchmark_cell& cell : cells) {
+        for (const auto& metric : metrics) {
+            summary s = summarize(cell.*metric.second);
+            outFile << (first ? "" : ",\n")
+                    << "  {\"algorithm\": \"" << cell.algorithm->name << "\", "
+                    << "\"distribution\": \"" << cell.input->name << "\", "
+                    << "\"size\": " << cell.size << ", "
+                    << "\"metric\": \"" << metric.first << "\", "
+                    << "\"repetitions\": " << (cell.*metric.second).size() << ", "
+                    << "\"mean\": " << s.mean << ", "
+                    << "\"median\": " << s.median << ", "
+                    << "\"stddev\": " << s.stddev << ", "
+                    << "\"ci95_low\": " << s.ci_low << ", "
+                    << "\"ci95_high\": " << s.ci_high << "}";
+            first = false;
+        }
+    }
+    outFile << "\n]\n";
+}
+
+int main(int argc, char* argv[]) {
+    benchmark_config config;
+    try {
+        std::vector<std::string> args(argv + 1, argv + argc);
+        if (!args.empty() && (args[0] == "--help" || args[0] == "-h")) {
+            print_usage();
+            return 0;
+        }
+        config = parse_args(args);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        print_usage();
+        return 1;
+    }
+
+    size_t skipped = 0;
+    std::vector<benchmark_cell> cells = make_cells(config, skipped);
+    std::cout << "Running " << cells.size() << " cells on " << config.threads << " threads";
+    if (skipped > 0) std::cout << " (" << skipped << " quadratic cells above size " << config.quadratic_cap << " skipped)";
+    std::cout << std::endl;
+
+    run_cells(cells, config);
+
+    if (!config.long_csv.empty()) write_long_csv(cells, config);
+    if (!config.json.empty()) write_json(cells, config);
+
+    std::cout << "Analysis complete." << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -1,21 +1,28 @@
 import matplotlib.pyplot as plt
 import pandas as pd
 
-# Read the CSV file
-data = pd.read_csv('sorting_analysis.csv')
+# Read the long-format results written by lab3
+data = pd.read_csv('benchmark_results.csv')
+comparisons = data[data['metric'] == 'comparisons']
+
+# Plot the average case if it was measured, otherwise the first distribution
+distributions = list(comparisons['distribution'].unique())
+distribution = 'Avg' if 'Avg' in distributions else distributions[0]
+comparisons = comparisons[comparisons['distribution'] == distribution]
 
 # Create a simple line plot
 plt.figure(figsize=(10, 6))
 
-# Plot average comparisons for each algorithm
-plt.plot(data['Size'], data['Insertion_Avg_Comp'], label='Insertion Sort', marker='o')
-plt.plot(data['Size'], data['Quick_Avg_Comp'], label='Quick Sort', marker='s')
-plt.plot(data['Size'], data['Comb_Avg_Comp'], label='Comb Sort', marker='^')
+# Plot average comparisons for each algorithm present in the results
+for algorithm, rows in comparisons.groupby('algorithm', sort=False):
+    rows = rows.sort_values('size')
+    plt.plot(rows['size'], rows['mean'], label=algorithm + ' Sort', marker='o')
+    plt.fill_between(rows['size'], rows['ci95_low'], rows['ci95_high'], alpha=0.2)
 
 # Add labels and title
 plt.xlabel('Array Size')
 plt.ylabel('Average Number of Comparisons')
-plt.title('Sorting Algorithms Performance Comparison')
+plt.title('Sorting Algorithms Performance Comparison (' + distribution + ')')
 plt.legend()
 plt.grid(True)
 
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+struct stats {
+    size_t comparison_count = 0;
+    size_t copy_count = 0;
+
+    stats& operator += (const stats& other) {
+        comparison_count += other.comparison_count;
+        copy_count += other.copy_count;
+        return *this;
+    }
+};
+
+// Counting policies. The sorts report every comparison and element copy to
+// the policy; no_count has empty inline hooks, so the uninstrumented
+// instantiation compiles down to the bare algorithm.
+struct no_count {
+    void compare() {}
+    void copy(size_t = 1) {}
+};
+
+struct count_stats {
+    stats statistics;
+
+    void compare() { statistics.comparison_count++; }
+    void copy(size_t n = 1) { statistics.copy_count += n; }
+};
+
+// Insertion Sort
+template <typename RandomIt, typename Compare, typename Counter>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp, Counter& counter) {
+    if (last - first < 2) return;
+
+    for (RandomIt i = first + 1; i != last; ++i) {
+        auto key = std::move(*i);
+        counter.copy();
+        RandomIt j = i;
+
+        while (j != first) {
+            counter.compare();
+            if (comp(key, *(j - 1))) {
+                *j = std::move(*(j - 1));
+                counter.copy();
+                --j;
+            } else {
+                break;
+            }
+        }
+        *j = std::move(key);
+        counter.copy();
+    }
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    no_count counter;
+    insertion_sort(first, last, comp, counter);
+}
+
+inline stats insertion_sort(std::vector<int>& arr) {
+    count_stats counter;
+    insertion_sort(arr.begin(), arr.end(), std::less<>(), counter);
+    return counter.statistics;
+}
+
+// Comb Sort
+template <typename RandomIt, typename Compare, typename Counter>
+void comb_sort(RandomIt first, RandomIt last, Compare comp, Counter& counter) {
+    auto n = last - first;
+    auto gap = n;
+    bool swapped = true;
+    const double shrink_factor = 1.3;
+
+    while (gap > 1 || swapped) {
+        gap = static_cast<decltype(gap)>(gap / shrink_factor);
+        if (gap < 1) gap = 1;
+
+        swapped = false;
+        for (RandomIt i = first; gap < last - i; ++i) {
+            counter.compare();
+            if (comp(*(i + gap), *i)) {
+                std::iter_swap(i, i + gap);
+                counter.copy(3);
+                swapped = true;
+            }
+        }
+    }
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void comb_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    no_count counter;
+    comb_sort(first, last, comp, counter);
+}
+
+inline stats comb_sort(std::vector<int>& arr) {
+    count_stats counter;
+    comb_sort(arr.begin(), arr.end(), std::less<>(), counter);
+    return counter.statistics;
+}
+
+// Quick Sort (Lomuto partition, last element as pivot).
+// Recurses into the smaller part and loops over the larger one,
+// so the stack depth stays logarithmic even on sorted input.
+template <typename RandomIt, typename Compare, typename Counter>
+void quick_sort(RandomIt first, RandomIt last, Compare comp, Counter& counter) {
+    while (last - first > 1) {
+        RandomIt high = last - 1;
+        auto pivot = *high;
+        counter.copy();
+        RandomIt i = first;
+
+        for (RandomIt j = first; j != high; ++j) {
+            counter.compare();
+            if (!comp(pivot, *j)) {
+                std::iter_swap(i, j);
+                counter.copy(3);
+                ++i;
+            }
+        }
+
+        std::iter_swap(i, high);
+        counter.copy(3);
+
+        if (i - first < last - (i + 1)) {
+            quick_sort(first, i, comp, counter);
+            first = i + 1;
+        } else {
+            quick_sort(i + 1, last, comp, counter);
+            last = i;
+        }
+    }
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void quick_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    no_count counter;
+    quick_sort(first, last, comp, counter);
+}
+
+inline stats quick_sort(std::vector<int>& arr) {
+    count_stats counter;
+    quick_sort(arr.begin(), arr.end(), std::less<>(), counter);
+    return counter.statistics;
+}
+
+
+// TimSort: natural runs are detected (descending ones are reversed),
+// short runs are extended to min_run with insertion sort, and runs are
+// merged through the usual stack invariants with galloping merges.
+template <typename RandomIt, typename Compare, typename Counter>
+class tim_sorter {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    using difference_type = typename std::iterator_traits<RandomIt>::difference_type;
+
+    struct run {
+        RandomIt base;
+        difference_type length;
+    };
+
+    static constexpr difference_type min_merge = 64;
+    static constexpr difference_type initial_min_gallop = 7;
+
+    Compare _comp;
+    Counter& _counter;
+    std::vector<value_type>& _buffer;
+    std::vector<run> _runs;
+    difference_type _min_gallop = initial_min_gallop;
+
+    bool less(const value_type& a, const value_type& b) {
+        _counter.compare();
+        return _comp(a, b);
+    }
+
+    static difference_type min_run_length(difference_type n) {
+        difference_type r = 0;
+        while (n >= min_merge) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // Returns the end of the run starting at first, reversing it if it is strictly descending
+    RandomIt find_run(RandomIt first, RandomIt last) {
+        RandomIt run_end = first + 1;
+        if (run_end == last) return last;
+
+        if (less(*run_end, *first)) {
+            ++run_end;
+            while (run_end != last && less(*run_end, *(run_end - 1))) ++run_end;
+            std::reverse(first, run_end);
+            _counter.copy(3 * ((run_end - first) / 2));
+        } else {
+            ++run_end;
+            while (run_end != last && !less(*run_end, *(run_end - 1))) ++run_end;
+        }
+        return run_end;
+    }
+
+    // Length of the prefix of [first, last) satisfying pred, which must be true..true false..false
+    template <typename It, typename Pred>
+    difference_type gallop_prefix(It first, It last, Pred pred) {
+        difference_type n = last - first;
+        if (n == 0 || !pred(first[0])) return 0;
+
+        difference_type prev = 0, ofs = 1;
+        while (ofs < n && pred(first[ofs])) {
+            prev = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        if (ofs > n) ofs = n;
+
+        difference_type lo = prev + 1, hi = ofs;
+        while (lo < hi) {
+            difference_type mid = lo + (hi - lo) / 2;
+            if (pred(first[mid])) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Length of the suffix of [first, last) satisfying pred, which must be false..false true..true
+    template <typename It, typename Pred>
+    difference_type gallop_suffix(It first, It last, Pred pred) {
+        difference_type n = last - first;
+        if (n == 0 || !pred(last[-1])) return 0;
+
+        difference_type prev = 0, ofs = 1;
+        while (ofs < n && pred(last[-1 - ofs])) {
+            prev = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        if (ofs > n) ofs = n;
+
+        difference_type lo = prev + 1, hi = ofs;
+        while (lo < hi) {
+            difference_type mid = lo + (hi - lo) / 2;
+            if (pred(last[-1 - mid])) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Merge with the shorter left run moved to the buffer, front to back
+    void merge_lo(RandomIt a, difference_type len1, RandomIt b, difference_type len2) {
+        _buffer.assign(std::make_move_iterator(a), std::make_move_iterator(a + len1));
+        _counter.copy(len1);
+
+        auto pa = _buffer.begin(), ea = _buffer.end();
+        RandomIt pb = b, eb = b + len2, dest = a;
+
+        while (pa != ea && pb != eb) {
+            difference_type wins_a = 0, wins_b = 0;
+            while (pa != ea && pb != eb && wins_a < _min_gallop && wins_b < _min_gallop) {
+                if (less(*pb, *pa)) {
+                    *dest++ = std::move(*pb++);
+                    wins_b++;
+                    wins_a = 0;
+                } else {
+                    *dest++ = std::move(*pa++);
+                    wins_a++;
+                    wins_b = 0;
+                }
+                _counter.copy();
+            }
+
+            while (pa != ea && pb != eb) {
+                const value_type& key_b = *pb;
+                difference_type count_a = gallop_prefix(pa, ea, [&](const value_type& x) { return !less(key_b, x); });
+                dest = std::move(pa, pa + count_a, dest);
+                pa += count_a;
+                _counter.copy(count_a);
+                if (pa == ea) break;
+
+                const value_type& key_a = *pa;
+                difference_type count_b = gallop_prefix(pb, eb, [&](const value_type& x) { return less(x, key_a); });
+                dest = std::move(pb, pb + count_b, dest);
+                pb += count_b;
+                _counter.copy(count_b);
+                if (pb == eb) break;
+
+                if (count_a < initial_min_gallop && count_b < initial_min_gallop) {
+                    _min_gallop++;
+                    break;
+                }
+                if (_min_gallop > 1) _min_gallop--;
+            }
+        }
+
+        _counter.copy(ea - pa);
+        std::move(pa, ea, dest);
+    }
+
+    // Merge with the shorter right run moved to the buffer, back to front
+    void merge_hi(RandomIt a, difference_type len1, RandomIt b, difference_type len2) {
+        _buffer.assign(std::make_move_iterator(b), std::make_move_iterator(b + len2));
+        _counter.copy(len2);
+
+        auto sb = _buffer.begin(), pb = _buffer.end();
+        RandomIt sa = a, pa = a + len1, dest = b + len2;
+
+        while (pa != sa && pb != sb) {
+            difference_type wins_a = 0, wins_b = 0;
+            while (pa != sa && pb != sb && wins_a < _min_gallop && wins_b < _min_gallop) {
+                if (less(*(pb - 1), *(pa - 1))) {
+                    *--dest = std::move(*--pa);
+                    wins_a++;
+                    wins_b = 0;
+                } else {
+                    *--dest = std::move(*--pb);
+                    wins_b++;
+                    wins_a = 0;
+                }
+                _counter.copy();
+            }
+
+            while (pa != sa && pb != sb) {
+                const value_type& key_b = *(pb - 1);
+                difference_type count_a = gallop_suffix(sa, pa, [&](const value_type& x) { return less(key_b, x); });
+                dest = std::move_backward(pa - count_a, pa, dest);
+                pa -= count_a;
+                _counter.copy(count_a);
+                if (pa == sa) break;
+
+                const value_type& key_a = *(pa - 1);
+                difference_type count_b = gallop_suffix(sb, pb, [&](const value_type& x) { return !less(x, key_a); });
+                dest = std::move_backward(pb - count_b, pb, dest);
+                pb -= count_b;
+                _counter.copy(count_b);
+                if (pb == sb) break;
+
+                if (count_a < initial_min_gallop && count_b < initial_min_gallop) {
+                    _min_gallop++;
+                    break;
+                }
+                if (_min_gallop > 1) _min_gallop--;
+            }
+        }
+
+        _counter.copy(pb - sb);
+        std::move_backward(sb, pb, dest);
+    }
+
+    void merge_at(size_t i) {
+        RandomIt a = _runs[i].base, b = _runs[i + 1].base;
+        difference_type len1 = _runs[i].length, len2 = _runs[i + 1].length;
+        _runs[i].length = len1 + len2;
+        _runs.erase(_runs.begin() + i + 1);
+
+        // Elements of the left run not greater than b[0] are already in place
+        const value_type& first_b = *b;
+        difference_type skip = gallop_prefix(a, a + len1, [&](const value_type& x) { return !less(first_b, x); });
+        a += skip;
+        len1 -= skip;
+        if (len1 == 0) return;
+
+        // So are elements of the right run not less than the last element of the left one
+        const value_type& last_a = a[len1 - 1];
+        len2 -= gallop_suffix(b, b + len2, [&](const value_type& x) { return !less(x, last_a); });
+        if (len2 == 0) return;
+
+        if (len1 <= len2) merge_lo(a, len1, b, len2);
+        else merge_hi(a, len1, b, len2);
+    }
+
+    void merge_collapse() {
+        while (_runs.size() > 1) {
+            size_t n = _runs.size() - 2;
+            if ((n > 0 && _runs[n - 1].length <= _runs[n].length + _runs[n + 1].length) ||
+                (n > 1 && _runs[n - 2].length <= _runs[n - 1].length + _runs[n].length)) {
+                if (_runs[n - 1].length < _runs[n + 1].length) n--;
+            } else if (_runs[n].length > _runs[n + 1].length) {
+                break;
+            }
+            merge_at(n);
+        }
+    }
+
+    void merge_force_collapse() {
+        while (_runs.size() > 1) {
+            size_t n = _runs.size() - 2;
+            if (n > 0 && _runs[n - 1].length < _runs[n + 1].length) n--;
+            merge_at(n);
+        }
+    }
+
+public:
+    tim_sorter(Compare comp, Counter& counter, std::vector<value_type>& buffer)
+        : _comp(comp), _counter(counter), _buffer(buffer) {}
+
+    void sort(RandomIt first, RandomIt last) {
+        difference_type n = last - first;
+        if (n < 2) return;
+
+        difference_type min_run = min_run_length(n);
+        while (first != last) {
+            RandomIt run_end = find_run(first, last);
+            difference_type length = run_end - first;
+            if (length < min_run) {
+                length = std::min(min_run, static_cast<difference_type>(last - first));
+                insertion_sort(first, first + length, _comp, _counter);
+            }
+
+            _runs.push_back({first, length});
+            merge_collapse();
+            first += length;
+        }
+        merge_force_collapse();
+    }
+};
+
+// Tim Sort. The merge buffer can be passed in to reuse it between calls.
+template <typename RandomIt, typename Compare, typename Counter>
+void tim_sort(RandomIt first, RandomIt last, Compare comp, Counter& counter,
+              std::vector<typename std::iterator_traits<RandomIt>::value_type>& buffer) {
+    tim_sorter<RandomIt, Compare, Counter>(comp, counter, buffer).sort(first, last);
+}
+
+template <typename RandomIt, typename Compare, typename Counter>
+void tim_sort(RandomIt first, RandomIt last, Compare comp, Counter& counter) {
+    std::vector<typename std::iterator_traits<RandomIt>::value_type> buffer;
+    tim_sort(first, last, comp, counter, buffer);
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void tim_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    no_count counter;
+    tim_sort(first, last, comp, counter);
+}
+
+inline stats tim_sort(std::vector<int>& arr) {
+    count_stats counter;
+    tim_sort(arr.begin(), arr.end(), std::less<>(), counter);
+    return counter.statistics;
+}